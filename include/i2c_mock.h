@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef enum {
     I2C_OK = 0,
@@ -21,6 +22,10 @@ void i2c_mock_reset_device(uint8_t dev_addr);
 void i2c_mock_set_timeout_every(uint32_t n);
 void i2c_mock_set_nack_every(uint32_t n);
 
+// While paused, operations never fail and don't advance the fault counter
+// (so extra traffic doesn't shift the every-Nth pattern).
+void i2c_mock_set_faults_paused(bool paused);
+
 // Low-level mock operations
 i2c_status_t i2c_mock_read(uint8_t dev_addr, uint8_t reg, uint8_t *buf, size_t len);
 i2c_status_t i2c_mock_write(uint8_t dev_addr, uint8_t reg, const uint8_t *data, size_t len);
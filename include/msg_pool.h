@@ -0,0 +1,51 @@
+#ifndef MSG_POOL_H
+#define MSG_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define MSG_POOL_MAX_CLASSES 4
+
+// One fixed-size block. The header lives outside the payload storage so the
+// free-list link never aliases data the producer/consumer is touching.
+typedef struct {
+    _Atomic uint32_t next;       // free-list link (block index), only used while free
+    uint16_t         class_idx;  // which size class owns this block
+    uint8_t         *data;       // payload (block_size bytes)
+    size_t           cap;        // == block_size of the class
+    size_t           len;        // bytes actually used by the producer
+} msg_buf_t;
+
+// A size class: N blocks of the same size, with a lock-free (Treiber) free list
+typedef struct {
+    msg_buf_t *bufs;         // block headers (external array, block_count entries)
+    uint8_t   *storage;      // payload memory (external array, block_size * block_count)
+    size_t     block_size;
+    uint32_t   block_count;
+
+    // (tag << 32) | index; tag bumps on every pop to avoid ABA
+    _Atomic uint64_t free_head;
+} msg_pool_class_t;
+
+typedef struct {
+    msg_pool_class_t classes[MSG_POOL_MAX_CLASSES];
+    size_t           class_count;
+} msg_pool_t;
+
+void       msg_pool_init(msg_pool_t *p);
+
+// Add a size class with user-provided storage.
+// Classes must be added in ascending block_size order.
+bool       msg_pool_add_class(msg_pool_t *p, msg_buf_t *bufs, uint8_t *storage,
+                              size_t block_size, uint32_t block_count);
+
+// Get a block that fits len bytes (smallest class first, then larger ones).
+// Returns NULL if every fitting class is exhausted. Never mallocs.
+msg_buf_t* msg_pool_alloc(msg_pool_t *p, size_t len);
+
+// Return a block to its class (consumer side, after use)
+void       msg_pool_free(msg_pool_t *p, msg_buf_t *b);
+
+#endif
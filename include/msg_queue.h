@@ -5,11 +5,14 @@
 #include <stdint.h>
 #include <pthread.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include "msg_pool.h"
 
 // A message that "sensor_task" sends to "logger_task"
 typedef enum {
     MSG_DATA = 0,
-    MSG_STOP = 1
+    MSG_STOP = 1,
+    MSG_BURST = 2     // multi-byte register dump in a pooled payload
 } msg_type_t;
 
 typedef struct {
@@ -18,10 +21,13 @@ typedef struct {
     int        value;     // simulated sensor value
     int        status;    // 0=OK, nonzero=error (later we’ll map to I2C errors)
     int        retries;   // how many retries were used (later)
+    msg_buf_t *payload;   // pooled payload (MSG_BURST only), consumer frees it
 } sample_msg_t;
 
+struct msg_queue_set;
+
 // A fixed-size blocking queue for sample_msg_t
-typedef struct {
+typedef struct msg_queue {
     sample_msg_t *buf;
     size_t capacity;
     size_t head;     // next write
@@ -31,8 +37,32 @@ typedef struct {
     pthread_mutex_t mtx;
     pthread_cond_t  not_empty;
     pthread_cond_t  not_full;
+
+    // Queue-set membership (NULL if not in a set).
+    // set_linked/set_next are protected by the set's mutex.
+    struct msg_queue_set *set;
+    uint8_t               set_prio;
+    bool                  set_linked;
+    struct msg_queue     *set_next;
 } msg_queue_t;
 
+// Queue set: one consumer blocks on many queues (like FreeRTOS queue sets).
+// Member queues with data sit on a per-priority ready list; a bitmap of
+// non-empty levels makes select O(1) regardless of how many queues are added.
+#define MSG_QUEUE_SET_PRIO_LEVELS 32
+
+typedef struct msg_queue_set {
+    pthread_mutex_t  mtx;
+    pthread_cond_t   ready;
+    size_t           waiters;      // consumers parked on ready
+
+    _Atomic uint32_t ready_mask;   // bit N set = level N has a ready queue
+    msg_queue_t     *head[MSG_QUEUE_SET_PRIO_LEVELS];
+    msg_queue_t     *tail[MSG_QUEUE_SET_PRIO_LEVELS];
+
+    uint32_t         spin_iters;   // lock-free polls before parking
+} msg_queue_set_t;
+
 bool   msg_queue_init(msg_queue_t *q, sample_msg_t *storage, size_t capacity);
 void   msg_queue_destroy(msg_queue_t *q);
 
@@ -40,4 +70,15 @@ void   msg_queue_destroy(msg_queue_t *q);
 bool   msg_queue_push(msg_queue_t *q, sample_msg_t item);
 bool   msg_queue_pop(msg_queue_t *q, sample_msg_t *out);
 
+bool   msg_queue_set_init(msg_queue_set_t *s, uint32_t spin_iters);
+void   msg_queue_set_destroy(msg_queue_set_t *s);
+
+// Register a queue (higher prio is served first). A queue belongs to at most one set.
+bool   msg_queue_set_add(msg_queue_set_t *s, msg_queue_t *q, uint8_t prio);
+bool   msg_queue_set_remove(msg_queue_set_t *s, msg_queue_t *q);
+
+// Block until a member has data and pop one item from it (highest prio first).
+// Spins spin_iters times before parking. src_out (optional) = source queue.
+bool   msg_queue_set_receive(msg_queue_set_t *s, sample_msg_t *out, msg_queue_t **src_out);
+
 #endif
@@ -8,12 +8,14 @@ static uint8_t  dev_regs[MAX_ADDR][REG_SIZE];
 static uint32_t op_count = 0;
 static uint32_t timeout_every = 0;
 static uint32_t nack_every = 0;
+static bool     faults_paused = false;
 
 void i2c_mock_reset_all(void) {
     memset(dev_regs, 0, sizeof(dev_regs));
     op_count = 0;
     timeout_every = 0;
     nack_every = 0;
+    faults_paused = false;
 }
 
 void i2c_mock_reset_device(uint8_t dev_addr) {
@@ -24,8 +26,11 @@ void i2c_mock_reset_device(uint8_t dev_addr) {
 
 void i2c_mock_set_timeout_every(uint32_t n) { timeout_every = n; }
 void i2c_mock_set_nack_every(uint32_t n)    { nack_every = n; }
+void i2c_mock_set_faults_paused(bool paused) { faults_paused = paused; }
 
 static i2c_status_t maybe_fail(void) {
+    if (faults_paused) return I2C_OK;
+
     op_count++;
 
     if (timeout_every != 0 && (op_count % timeout_every) == 0) return I2C_ERR_TIMEOUT;
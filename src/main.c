@@ -4,6 +4,7 @@
 #include <windows.h>   // Sleep, GetTickCount64
 
 #include "msg_queue.h"
+#include "msg_pool.h"
 #include "ringbuf.h"
 #include "i2c_mock.h"
 #include "i2c_util.h"
@@ -57,6 +58,7 @@ static i2c_status_t i2c_read_reg_retry(uint8_t dev, uint8_t reg,
 // --- Thread args ---
 typedef struct {
     msg_queue_t *q;
+    msg_queue_t *alarm_q;          // failed samples go here (served first)
     int samples;
     int period_ms;
 
@@ -66,11 +68,19 @@ typedef struct {
 
     uint32_t timeout_every;
     uint32_t nack_every;
+
+    // burst read: every N samples dump a register bank into a pooled buffer
+    msg_pool_t *pool;
+    uint32_t burst_every;          // 0 = disabled
+    uint8_t  burst_reg;
+    size_t   burst_len;
 } sensor_args_t;
 
 typedef struct {
-    msg_queue_t *q;
+    msg_queue_set_t *set;          // data + alarm queues
+    msg_queue_t     *alarm_q;
     ringbuf_t   *log_rb;
+    msg_pool_t  *pool;             // MSG_BURST payloads go back here
 
     // flush policy
     uint32_t flush_every_msgs;     // flush after N messages
@@ -95,6 +105,9 @@ static void* sensor_task(void* arg) {
     // Attempt-failure counters (what happened during retries)
     uint32_t fail_timeout = 0, fail_nack = 0, fail_other = 0;
 
+    // Burst reads that could not be sent
+    uint32_t burst_no_block = 0, burst_read_fail = 0;
+
     for (int i = 0; i < a->samples; i++) {
         // Update fake device register value reliably (no faults during write)
         i2c_mock_set_timeout_every(0);
@@ -130,8 +143,44 @@ static void* sensor_task(void* arg) {
         msg.value = (st == I2C_OK) ? (int)read_val : -1;
         msg.status = (int)st;
         msg.retries = retries_used;
-
-        msg_queue_push(a->q, msg);
+        msg.payload = NULL;
+
+        // Failures skip ahead of the regular data stream
+        msg_queue_push((st == I2C_OK) ? a->q : a->alarm_q, msg);
+
+        // Burst read straight into a pool block; only the handle goes through the queue
+        if (a->burst_every != 0 && ((uint32_t)(i + 1) % a->burst_every) == 0) {
+            msg_buf_t *b = msg_pool_alloc(a->pool, a->burst_len);
+            if (b == NULL) {
+                burst_no_block++;
+            } else {
+                // Burst traffic is invisible to fault injection, so the
+                // timeout_every/nack_every pattern on samples stays the same
+                i2c_mock_set_faults_paused(true);
+
+                int burst_retries = 0;
+                i2c_status_t bst = i2c_read_reg_retry(a->dev_addr, a->burst_reg,
+                                                      b->data, b->len,
+                                                      a->retries,
+                                                      &burst_retries,
+                                                      NULL, NULL, NULL);
+
+                i2c_mock_set_faults_paused(false);
+
+                if (bst != I2C_OK) {
+                    msg_pool_free(a->pool, b);
+                    burst_read_fail++;
+                } else {
+                    sample_msg_t burst = {0};
+                    burst.type = MSG_BURST;
+                    burst.ts_ms = (uint64_t)GetTickCount64();
+                    burst.status = (int)bst;
+                    burst.retries = burst_retries;
+                    burst.payload = b;
+                    msg_queue_push(a->q, burst);
+                }
+            }
+        }
 
         // Sleep until next tick
         next += (uint64_t)a->period_ms;
@@ -147,9 +196,11 @@ static void* sensor_task(void* arg) {
     uint32_t fail_total = fail_timeout + fail_nack + fail_other;
 
     printf("[sensor_task] summary: final(ok=%u timeout=%u nack=%u other=%u)  "
-           "attempt_fail(total=%u timeout=%u nack=%u other=%u)\n",
+           "attempt_fail(total=%u timeout=%u nack=%u other=%u)  "
+           "burst_drop(no_block=%u read_fail=%u)\n",
            ok, timeout, nack, other,
-           fail_total, fail_timeout, fail_nack, fail_other);
+           fail_total, fail_timeout, fail_nack, fail_other,
+           burst_no_block, burst_read_fail);
 
     return NULL;
 }
@@ -171,8 +222,10 @@ static void* logger_task(void* arg) {
 
 
     while (1) {
+        // Wait on every member queue at once; alarms win over data
+        msg_queue_t *src = NULL;
         sample_msg_t msg;
-        msg_queue_pop(a->q, &msg);
+        msg_queue_set_receive(a->set, &msg, &src);
 
         if (msg.type == MSG_STOP) {
             flush_ringbuf_to_stdout(a->log_rb);
@@ -183,12 +236,32 @@ static void* logger_task(void* arg) {
         const char *st_str = i2c_status_str((i2c_status_t)msg.status);
 
         char line[128];
-        int len = snprintf(line, sizeof(line),
-                           "[logger_task] t=%llu ms value=%d status=%s retries=%d\n",
+        int len;
+
+        if (msg.type == MSG_BURST) {
+            // Log a summary of the payload, then hand the block back to the pool
+            const msg_buf_t *b = msg.payload;
+            uint32_t sum = 0;
+            for (size_t k = 0; k < b->len; k++) sum += b->data[k];
+
+            len = snprintf(line, sizeof(line),
+                           "[logger_task] t=%llu ms burst len=%zu sum=%u status=%s retries=%d\n",
+                           (unsigned long long)msg.ts_ms,
+                           b->len,
+                           sum,
+                           st_str,
+                           msg.retries);
+
+            msg_pool_free(a->pool, msg.payload);
+        } else {
+            len = snprintf(line, sizeof(line),
+                           "[logger_task]%s t=%llu ms value=%d status=%s retries=%d\n",
+                           (src == a->alarm_q) ? " ALARM" : "",
                            (unsigned long long)msg.ts_ms,
                            msg.value,
                            st_str,
                            msg.retries);
+        }
 
         if (len < 0) len = 0;
         if (len > (int)sizeof(line)) len = (int)sizeof(line);
@@ -232,30 +305,61 @@ int main(void) {
         return 1;
     }
 
+    // Alarm queue + queue set so the logger can block on both
+    sample_msg_t alarm_storage[4];
+    msg_queue_t alarm_q;
+    if (!msg_queue_init(&alarm_q, alarm_storage, 4)) {
+        printf("Queue init failed\n");
+        return 1;
+    }
+
+    msg_queue_set_t qset;
+    msg_queue_set_init(&qset, 1000);
+    msg_queue_set_add(&qset, &q, 0);
+    msg_queue_set_add(&qset, &alarm_q, 1);
+
     // Log ring buffer storage
     uint8_t log_storage[256];
     ringbuf_t log_rb;
     ringbuf_init(&log_rb, log_storage, sizeof(log_storage));
 
+    // Payload pool: one class sized for a full register bank
+    static uint8_t   pool_storage[256 * 4];
+    static msg_buf_t pool_hdr[4];
+    msg_pool_t pool;
+    msg_pool_init(&pool);
+    if (!msg_pool_add_class(&pool, pool_hdr, pool_storage, 256, 4)) {
+        printf("Pool init failed\n");
+        return 1;
+    }
+
     pthread_t sensor_t, logger_t;
 
     // You can tweak these values for different demos
     sensor_args_t sargs = {
         .q = &q,
+        .alarm_q = &alarm_q,
         .samples = 20,
         .period_ms = 200,
 
         .dev_addr = 0x48,
         .reg_addr = 0x10,
-        .retries = 2,          // try 0,1,2
+        .retries = 2,          // try 0,1,2 (0 = failed samples reach the alarm queue)
 
         .timeout_every = 5,    // try 0,5,7
-        .nack_every = 7        // try 0,7,9
+        .nack_every = 7,       // try 0,7,9
+
+        .pool = &pool,
+        .burst_every = 5,      // try 0,1,5
+        .burst_reg = 0x00,
+        .burst_len = 256       // whole register bank
     };
 
     logger_args_t largs = {
-    .q = &q,
+    .set = &qset,
+    .alarm_q = &alarm_q,
     .log_rb = &log_rb,
+    .pool = &pool,
     .flush_every_msgs = 5,
     .flush_interval_ms = 1000
 };
@@ -266,6 +370,10 @@ int main(void) {
     pthread_join(sensor_t, NULL);
     pthread_join(logger_t, NULL);
 
+    msg_queue_set_remove(&qset, &alarm_q);
+    msg_queue_set_remove(&qset, &q);
+    msg_queue_set_destroy(&qset);
+    msg_queue_destroy(&alarm_q);
     msg_queue_destroy(&q);
 
     printf("Scheduler sim done.\n");
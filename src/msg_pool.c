@@ -0,0 +1,107 @@
+#include "msg_pool.h"
+
+#define FREE_NONE UINT32_MAX
+
+static uint64_t pack_head(uint32_t tag, uint32_t idx) {
+    return ((uint64_t)tag << 32) | idx;
+}
+
+static uint32_t head_idx(uint64_t h) { return (uint32_t)h; }
+static uint32_t head_tag(uint64_t h) { return (uint32_t)(h >> 32); }
+
+void msg_pool_init(msg_pool_t *p) {
+    if (!p) return;
+    p->class_count = 0;
+}
+
+bool msg_pool_add_class(msg_pool_t *p, msg_buf_t *bufs, uint8_t *storage,
+                        size_t block_size, uint32_t block_count) {
+    if (!p || !bufs || !storage || block_size == 0) return false;
+    if (block_count == 0 || block_count == FREE_NONE) return false;
+    if (p->class_count >= MSG_POOL_MAX_CLASSES) return false;
+
+    // Keep classes sorted so alloc can pick the smallest fit with a linear scan
+    if (p->class_count > 0 &&
+        p->classes[p->class_count - 1].block_size >= block_size) {
+        return false;
+    }
+
+    uint16_t ci = (uint16_t)p->class_count;
+    msg_pool_class_t *c = &p->classes[ci];
+
+    c->bufs = bufs;
+    c->storage = storage;
+    c->block_size = block_size;
+    c->block_count = block_count;
+
+    // Chain every block into the free list: 0 -> 1 -> ... -> N-1
+    for (uint32_t i = 0; i < block_count; i++) {
+        bufs[i].class_idx = ci;
+        bufs[i].data = &storage[(size_t)i * block_size];
+        bufs[i].cap = block_size;
+        bufs[i].len = 0;
+        atomic_init(&bufs[i].next, (i + 1 < block_count) ? i + 1 : FREE_NONE);
+    }
+    atomic_init(&c->free_head, pack_head(0, 0));
+
+    p->class_count++;
+    return true;
+}
+
+static msg_buf_t* class_pop(msg_pool_class_t *c) {
+    uint64_t old = atomic_load_explicit(&c->free_head, memory_order_acquire);
+
+    while (head_idx(old) != FREE_NONE) {
+        uint32_t idx = head_idx(old);
+
+        // May read a stale link if another thread grabbed this block meanwhile;
+        // the tag makes the CAS below fail in that case.
+        uint32_t next = atomic_load_explicit(&c->bufs[idx].next, memory_order_relaxed);
+        uint64_t new_head = pack_head(head_tag(old) + 1, next);
+
+        if (atomic_compare_exchange_weak_explicit(&c->free_head, &old, new_head,
+                                                  memory_order_acquire,
+                                                  memory_order_acquire)) {
+            return &c->bufs[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static void class_push(msg_pool_class_t *c, msg_buf_t *b) {
+    uint32_t idx = (uint32_t)(b - c->bufs);
+    uint64_t old = atomic_load_explicit(&c->free_head, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&b->next, head_idx(old), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&c->free_head, &old,
+                                                    pack_head(head_tag(old), idx),
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+msg_buf_t* msg_pool_alloc(msg_pool_t *p, size_t len) {
+    if (!p || len == 0) return NULL;
+
+    for (size_t i = 0; i < p->class_count; i++) {
+        msg_pool_class_t *c = &p->classes[i];
+        if (c->block_size < len) continue;
+
+        // Smallest fitting class first; spill into larger classes if it is empty
+        msg_buf_t *b = class_pop(c);
+        if (b) {
+            b->len = len;
+            return b;
+        }
+    }
+
+    return NULL;
+}
+
+void msg_pool_free(msg_pool_t *p, msg_buf_t *b) {
+    if (!p || !b || b->class_idx >= p->class_count) return;
+
+    b->len = 0;
+    class_push(&p->classes[b->class_idx], b);
+}
@@ -13,6 +13,11 @@ bool msg_queue_init(msg_queue_t *q, sample_msg_t *storage, size_t capacity) {
     pthread_cond_init(&q->not_empty, NULL);
     pthread_cond_init(&q->not_full, NULL);
 
+    q->set = NULL;
+    q->set_prio = 0;
+    q->set_linked = false;
+    q->set_next = NULL;
+
     return true;
 }
 
@@ -23,6 +28,30 @@ void msg_queue_destroy(msg_queue_t *q) {
     pthread_cond_destroy(&q->not_full);
 }
 
+// Put q on its priority level's ready list. Caller holds q->mtx.
+static void set_mark_ready(msg_queue_t *q) {
+    msg_queue_set_t *s = q->set;
+
+    pthread_mutex_lock(&s->mtx);
+
+    if (!q->set_linked) {
+        uint8_t p = q->set_prio;
+
+        q->set_next = NULL;
+        if (s->tail[p]) s->tail[p]->set_next = q;
+        else            s->head[p] = q;
+        s->tail[p] = q;
+        q->set_linked = true;
+
+        atomic_fetch_or_explicit(&s->ready_mask, 1u << p, memory_order_release);
+
+        // Only pay for a wakeup if someone is actually parked
+        if (s->waiters > 0) pthread_cond_signal(&s->ready);
+    }
+
+    pthread_mutex_unlock(&s->mtx);
+}
+
 bool msg_queue_push(msg_queue_t *q, sample_msg_t item) {
     if (!q) return false;
 
@@ -38,12 +67,29 @@ bool msg_queue_push(msg_queue_t *q, sample_msg_t item) {
     q->head = (q->head + 1) % q->capacity;
     q->count++;
 
+    // Empty -> non-empty: tell the set this queue has data
+    if (q->set && q->count == 1) set_mark_ready(q);
+
     // Signal that queue is not empty now
     pthread_cond_signal(&q->not_empty);
     pthread_mutex_unlock(&q->mtx);
     return true;
 }
 
+// Take the item at tail. Caller holds q->mtx and has checked count > 0.
+static void pop_locked(msg_queue_t *q, sample_msg_t *out) {
+    // Read item at tail
+    *out = q->buf[q->tail];
+    q->tail = (q->tail + 1) % q->capacity;
+    q->count--;
+
+    // Still has data: put it back on the set's ready list (select unlinked it)
+    if (q->set && q->count > 0) set_mark_ready(q);
+
+    // Signal that queue is not full now
+    pthread_cond_signal(&q->not_full);
+}
+
 bool msg_queue_pop(msg_queue_t *q, sample_msg_t *out) {
     if (!q || !out) return false;
 
@@ -54,13 +100,153 @@ bool msg_queue_pop(msg_queue_t *q, sample_msg_t *out) {
         pthread_cond_wait(&q->not_empty, &q->mtx);
     }
 
-    // Read item at tail
-    *out = q->buf[q->tail];
-    q->tail = (q->tail + 1) % q->capacity;
-    q->count--;
+    pop_locked(q, out);
+
+    pthread_mutex_unlock(&q->mtx);
+    return true;
+}
+
+bool msg_queue_set_init(msg_queue_set_t *s, uint32_t spin_iters) {
+    if (!s) return false;
+
+    pthread_mutex_init(&s->mtx, NULL);
+    pthread_cond_init(&s->ready, NULL);
+    s->waiters = 0;
+
+    atomic_init(&s->ready_mask, 0u);
+    for (size_t i = 0; i < MSG_QUEUE_SET_PRIO_LEVELS; i++) {
+        s->head[i] = NULL;
+        s->tail[i] = NULL;
+    }
+
+    s->spin_iters = spin_iters;
+    return true;
+}
+
+void msg_queue_set_destroy(msg_queue_set_t *s) {
+    if (!s) return;
+    pthread_mutex_destroy(&s->mtx);
+    pthread_cond_destroy(&s->ready);
+}
+
+bool msg_queue_set_add(msg_queue_set_t *s, msg_queue_t *q, uint8_t prio) {
+    if (!s || !q || prio >= MSG_QUEUE_SET_PRIO_LEVELS) return false;
+
+    pthread_mutex_lock(&q->mtx);
+
+    if (q->set != NULL) {
+        pthread_mutex_unlock(&q->mtx);
+        return false;
+    }
+
+    q->set = s;
+    q->set_prio = prio;
+    q->set_linked = false;
+    q->set_next = NULL;
+
+    // Items pushed before joining must still wake the consumer
+    if (q->count > 0) set_mark_ready(q);
+
+    pthread_mutex_unlock(&q->mtx);
+    return true;
+}
+
+bool msg_queue_set_remove(msg_queue_set_t *s, msg_queue_t *q) {
+    if (!s || !q) return false;
+
+    pthread_mutex_lock(&q->mtx);
+
+    if (q->set != s) {
+        pthread_mutex_unlock(&q->mtx);
+        return false;
+    }
+
+    pthread_mutex_lock(&s->mtx);
+
+    if (q->set_linked) {
+        // Unlink from its level (rare path, linear in that level only)
+        uint8_t p = q->set_prio;
+        msg_queue_t *prev = NULL;
+        msg_queue_t *it = s->head[p];
+
+        while (it && it != q) {
+            prev = it;
+            it = it->set_next;
+        }
+
+        if (prev) prev->set_next = q->set_next;
+        else      s->head[p] = q->set_next;
+        if (s->tail[p] == q) s->tail[p] = prev;
+
+        if (s->head[p] == NULL) {
+            atomic_fetch_and_explicit(&s->ready_mask, ~(1u << p), memory_order_relaxed);
+        }
+    }
+
+    q->set_linked = false;
+    q->set_next = NULL;
+
+    pthread_mutex_unlock(&s->mtx);
+
+    q->set = NULL;
 
-    // Signal that queue is not full now
-    pthread_cond_signal(&q->not_full);
     pthread_mutex_unlock(&q->mtx);
     return true;
 }
+
+// Unlink and return the highest-priority ready queue, blocking until one exists
+static msg_queue_t* set_select(msg_queue_set_t *s) {
+    // Spin first: a producer is often only a few instructions away
+    for (uint32_t i = 0; i < s->spin_iters; i++) {
+        if (atomic_load_explicit(&s->ready_mask, memory_order_acquire) != 0) break;
+    }
+
+    pthread_mutex_lock(&s->mtx);
+
+    // Then park until some member has data
+    uint32_t mask;
+    while ((mask = atomic_load_explicit(&s->ready_mask, memory_order_relaxed)) == 0) {
+        s->waiters++;
+        pthread_cond_wait(&s->ready, &s->mtx);
+        s->waiters--;
+    }
+
+    // Highest ready level, FIFO within the level
+    uint8_t p = (uint8_t)(31 - __builtin_clz(mask));
+    msg_queue_t *q = s->head[p];
+
+    s->head[p] = q->set_next;
+    if (s->head[p] == NULL) {
+        s->tail[p] = NULL;
+        atomic_fetch_and_explicit(&s->ready_mask, ~(1u << p), memory_order_relaxed);
+    }
+    q->set_next = NULL;
+    q->set_linked = false;
+
+    pthread_mutex_unlock(&s->mtx);
+    return q;
+}
+
+bool msg_queue_set_receive(msg_queue_set_t *s, sample_msg_t *out, msg_queue_t **src_out) {
+    if (!s || !out) return false;
+
+    while (1) {
+        msg_queue_t *q = set_select(s);
+
+        pthread_mutex_lock(&q->mtx);
+
+        // A direct msg_queue_pop() may have drained it since it was linked.
+        // It is unlinked now; the next push relinks it.
+        if (q->count == 0) {
+            pthread_mutex_unlock(&q->mtx);
+            continue;
+        }
+
+        pop_locked(q, out);   // relinks q if items remain
+
+        pthread_mutex_unlock(&q->mtx);
+
+        if (src_out) *src_out = q;
+        return true;
+    }
+}